@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+#include <gocxx/io/io.h>
+
+namespace gocxx::io {
+
+    struct ChunkerOptions {
+        std::size_t minSize = 2 * 1024;
+        std::size_t avgSize = 8 * 1024;
+        std::size_t maxSize = 64 * 1024;
+        bool fingerprint = false;   // fill Chunk::fingerprint (XXH64, not cryptographic)
+    };
+
+    // View of one content-defined chunk. `data` points into the reader's
+    // buffer and stays valid until the next call on the reader.
+    struct Chunk {
+        const uint8_t* data = nullptr;
+        std::size_t size = 0;
+        std::size_t offset = 0;      // position in the stream
+        uint64_t fingerprint = 0;
+    };
+
+    // Splits a stream into content-defined chunks with FastCDC (gear hash over a
+    // 64-byte window, normalized chunking). Boundaries depend only on content,
+    // so an insertion upstream only changes the chunks around it.
+    class ChunkingReader : public Reader {
+    public:
+        explicit ChunkingReader(std::shared_ptr<Reader> r, ChunkerOptions options = {});
+
+        // Returns the next chunk without copying. ErrEOF once the stream is drained.
+        // After a partial read(), first returns the unread rest of that chunk.
+        gocxx::base::Result<Chunk> next();
+
+        // Copies chunk data out; a single call never crosses a chunk boundary.
+        gocxx::base::Result<std::size_t> read(uint8_t* buffer, std::size_t size) override;
+
+        const ChunkerOptions& options() const { return opts; }
+
+    private:
+        gocxx::base::Result<Chunk> nextChunk();
+        gocxx::base::Result<std::size_t> fill();
+        std::size_t cutPoint(const uint8_t* data, std::size_t size) const;
+
+        std::shared_ptr<Reader> r;
+        ChunkerOptions opts;
+        uint64_t maskS;
+        uint64_t maskL;
+
+        std::unique_ptr<uint8_t[]> buf;
+        std::size_t capacity;
+        std::size_t start = 0;
+        std::size_t end = 0;
+        std::size_t streamOffset = 0;
+        bool eof = false;
+
+        Chunk current;               // unread remainder for read()
+    };
+
+    // XXH64 of `size` bytes; used for chunk fingerprints.
+    uint64_t Fingerprint(const uint8_t* data, std::size_t size, uint64_t seed = 0);
+
+} // namespace gocxx::io
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <gocxx/io/io.h>
+
+namespace gocxx::io {
+
+    // File backed by an OS file descriptor.
+    // seek() supports SeekData/SeekHole; where the platform or filesystem cannot
+    // report holes, the whole file is treated as one data extent.
+    class File : public Reader, public Writer, public ReaderAt, public WriterAt,
+                 public Seeker, public HolePuncher, public Closer {
+    public:
+        // Takes ownership of `fd`.
+        explicit File(int fd, std::string name = "");
+        ~File() override;
+
+        File(const File&) = delete;
+        File& operator=(const File&) = delete;
+
+        // Opens an existing file read-only.
+        static gocxx::base::Result<std::shared_ptr<File>> Open(const std::string& name);
+
+        // Creates or truncates a file for reading and writing.
+        static gocxx::base::Result<std::shared_ptr<File>> Create(const std::string& name);
+
+        gocxx::base::Result<std::size_t> read(uint8_t* buffer, std::size_t size) override;
+        gocxx::base::Result<std::size_t> write(const uint8_t* buffer, std::size_t size) override;
+        gocxx::base::Result<std::size_t> readAt(uint8_t* buffer, std::size_t size, std::size_t offset) override;
+        gocxx::base::Result<std::size_t> writeAt(const uint8_t* buffer, std::size_t size, std::size_t offset) override;
+        gocxx::base::Result<std::size_t> seek(std::size_t offset, whence whence) override;
+        gocxx::base::Result<std::size_t> punchHole(std::size_t offset, std::size_t size) override;
+        void close() override;
+
+        int fd() const { return fd_; }
+        const std::string& name() const { return name_; }
+
+    private:
+        int fd_;
+        std::string name_;
+    };
+
+} // namespace gocxx::io
@@ -66,7 +66,9 @@ namespace gocxx::io {
     enum whence {
         SeekStart = 0,   // io.SeekStart
         SeekCurrent = 1, // io.SeekCurrent
-        SeekEnd = 2      // io.SeekEnd
+        SeekEnd = 2,     // io.SeekEnd
+        SeekData = 3,    // next offset >= `offset` holding data (lseek SEEK_DATA)
+        SeekHole = 4     // next hole at or after `offset`; end of file counts (lseek SEEK_HOLE)
     };
 
     class Seeker {
@@ -75,6 +77,13 @@ namespace gocxx::io {
         virtual gocxx::base::Result<std::size_t> seek(std::size_t offset, whence whence) = 0;
     };
 
+    // Deallocates a byte range so it reads back as zeros.
+    class HolePuncher {
+    public:
+        virtual ~HolePuncher() = default;
+        virtual gocxx::base::Result<std::size_t> punchHole(std::size_t offset, std::size_t size) = 0;
+    };
+
     class OffsetWriter : public Writer, public WriterAt, public Seeker {
     public:
         explicit OffsetWriter(std::shared_ptr<WriterAt> w, std::size_t offset);
@@ -88,6 +97,32 @@ namespace gocxx::io {
         std::size_t currentOffset;
     };
 
+    // Writer over a WriterAt that skips all-zero blocks instead of writing them.
+    // Skipped ranges are punched if the target is a HolePuncher; otherwise they are
+    // assumed to already read as zero (e.g. a freshly created file).
+    class SparseWriter : public Writer, public Seeker {
+    public:
+        explicit SparseWriter(std::shared_ptr<WriterAt> w, std::size_t blockSize = 4096);
+        gocxx::base::Result<std::size_t> write(const uint8_t* buffer, std::size_t size) override;
+        gocxx::base::Result<std::size_t> seek(std::size_t offset, whence whence) override;
+
+        // Punches any pending zero run and extends the target to the logical size
+        // if the data ended in a skipped block. Call once after the last write.
+        gocxx::base::Result<std::size_t> finish();
+
+    private:
+        gocxx::base::Result<std::size_t> flushHole();
+
+        std::shared_ptr<WriterAt> w;
+        std::shared_ptr<HolePuncher> puncher;
+        std::size_t blockSize;
+        std::size_t currentOffset = 0;
+        std::size_t logicalEnd = 0;
+        std::size_t physicalEnd = 0;
+        std::size_t holeStart = 0;
+        std::size_t holeSize = 0;
+    };
+
     class ByteReader {
     public:
         virtual ~ByteReader() = default;
@@ -115,6 +150,11 @@ namespace gocxx::io {
     // Function declarations
     gocxx::base::Result<std::size_t> Copy(std::shared_ptr<Writer> dst, std::shared_ptr<Reader> src);
     gocxx::base::Result<std::size_t> CopyBuffer(std::shared_ptr<Writer> dst, std::shared_ptr<Reader> src, uint8_t* buf, std::size_t size);
+    // Copies src to dst like Copy, but keeps holes: data extents are found with
+    // SeekData/SeekHole and all-zero blocks are skipped by seeking dst. Skipped
+    // ranges follow the same rule as SparseWriter; an unseekable dst gets the
+    // zeros written out. Returns the number of bytes copied, holes included.
+    gocxx::base::Result<std::size_t> CopySparse(std::shared_ptr<Writer> dst, std::shared_ptr<Reader> src);
     gocxx::base::Result<std::size_t> CopyN(std::shared_ptr<Writer> dst, std::shared_ptr<Reader> src, std::size_t n);
     gocxx::base::Result<std::size_t> ReadAll(std::shared_ptr<Reader> r, std::vector<uint8_t>& out);
     gocxx::base::Result<std::size_t> ReadAtLeast(std::shared_ptr<Reader> r, std::vector<uint8_t>& buf, std::size_t min);
@@ -134,4 +174,30 @@ namespace gocxx::io {
 
     std::pair<std::shared_ptr<PipeReader>, std::shared_ptr<PipeWriter>> Pipe();
 
+    // Message-oriented, multi-producer/single-consumer pipe.
+    // Each write() is delivered as one message; boundaries are preserved.
+    class MessagePipeReader : public PipeReader {
+    public:
+        // Reads the next message into `buffer`.
+        // If the message does not fit, it stays queued and ErrShortBuffer is returned.
+        gocxx::base::Result<std::size_t> read(uint8_t* buffer, std::size_t size) override = 0;
+
+        // Blocks until at least one message is available, then moves up to `max`
+        // messages into `out`. Returns the number of messages appended.
+        virtual gocxx::base::Result<std::size_t> readBatch(std::vector<std::vector<uint8_t>>& out, std::size_t max) = 0;
+
+        // Number of lanes still attached: live writers plus destroyed writers
+        // whose messages have not been read yet. Call from the reading thread.
+        virtual std::size_t lanes() = 0;
+    };
+
+    class MessagePipeWriter : public PipeWriter {
+    public:
+        // Returns a new writer for the same pipe with its own lock-free lane.
+        // Use one writer per producer thread; a single writer is not safe for concurrent use.
+        virtual std::shared_ptr<MessagePipeWriter> newWriter() = 0;
+    };
+
+    std::pair<std::shared_ptr<MessagePipeReader>, std::shared_ptr<MessagePipeWriter>> MessagePipe();
+
 } // namespace gocxx::io
\ No newline at end of file
@@ -32,6 +32,9 @@ namespace gocxx::io {
     inline const std::shared_ptr<errors::Error> ErrBufferTooSmall =
         std::make_shared<errors::simpleError>("buffer too small");
 
+    inline const std::shared_ptr<errors::Error> ErrUnsupported =
+        std::make_shared<errors::simpleError>("operation not supported");
+
     inline const std::shared_ptr<errors::Error> ErrUnknownIO =
         std::make_shared<errors::simpleError>("unknown I/O error");
 
@@ -0,0 +1,245 @@
+#include "gocxx/io/chunking.h"
+#include "gocxx/io/io_errors.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace gocxx::io {
+
+    using gocxx::base::Result;
+
+    namespace {
+
+        constexpr std::size_t kWindow = 64;
+
+        // Gear table from splitmix64 with a fixed seed. Chunk boundaries depend
+        // on these values, so changing them invalidates existing dedup indexes.
+        constexpr std::array<uint64_t, 256> makeGear() {
+            std::array<uint64_t, 256> table{};
+            uint64_t state = 0x676f6378785f696fULL;
+            for (auto& v : table) {
+                state += 0x9E3779B97F4A7C15ULL;
+                uint64_t z = state;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                v = z ^ (z >> 31);
+            }
+            return table;
+        }
+
+        constexpr std::array<uint64_t, 256> kGear = makeGear();
+
+        // Mask of the top `bits` bits; they mix in all 64 bytes of the window.
+        uint64_t topMask(unsigned bits) {
+            return bits == 0 ? 0 : ~0ULL << (64 - bits);
+        }
+
+        // First i in [begin, end) where the gear hash of the window ending at i
+        // has no `mask` bits set, or `end`. Requires begin >= kWindow - 1.
+        std::size_t scan(const uint8_t* d, std::size_t begin, std::size_t end, uint64_t mask) {
+            uint64_t fp = 0;
+            for (std::size_t i = begin + 1 - kWindow; i < begin; ++i) {
+                fp = (fp << 1) + kGear[d[i]];
+            }
+            for (std::size_t i = begin; i < end; ++i) {
+                fp = (fp << 1) + kGear[d[i]];
+                if ((fp & mask) == 0) return i;
+            }
+            return end;
+        }
+
+        uint64_t rotl(uint64_t x, int r) {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        uint64_t load64(const uint8_t* p) {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        uint32_t load32(const uint8_t* p) {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        constexpr uint64_t P1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr uint64_t P3 = 0x165667B19E3779F9ULL;
+        constexpr uint64_t P4 = 0x85EBCA77C2B2AE63ULL;
+        constexpr uint64_t P5 = 0x27D4EB2F165667C5ULL;
+
+        uint64_t xxRound(uint64_t acc, uint64_t input) {
+            acc += input * P2;
+            acc = rotl(acc, 31);
+            return acc * P1;
+        }
+
+        uint64_t xxMerge(uint64_t acc, uint64_t val) {
+            acc ^= xxRound(0, val);
+            return acc * P1 + P4;
+        }
+
+    } // namespace
+
+    // Little-endian loads; matches reference XXH64 on little-endian hosts.
+    uint64_t Fingerprint(const uint8_t* data, std::size_t size, uint64_t seed) {
+        const uint8_t* p = data;
+        const uint8_t* const last = data + size;
+        uint64_t h;
+
+        if (size >= 32) {
+            uint64_t v1 = seed + P1 + P2;
+            uint64_t v2 = seed + P2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - P1;
+            for (; last - p >= 32; p += 32) {
+                v1 = xxRound(v1, load64(p));
+                v2 = xxRound(v2, load64(p + 8));
+                v3 = xxRound(v3, load64(p + 16));
+                v4 = xxRound(v4, load64(p + 24));
+            }
+            h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+            h = xxMerge(h, v1);
+            h = xxMerge(h, v2);
+            h = xxMerge(h, v3);
+            h = xxMerge(h, v4);
+        } else {
+            h = seed + P5;
+        }
+
+        h += static_cast<uint64_t>(size);
+
+        for (; last - p >= 8; p += 8) {
+            h ^= xxRound(0, load64(p));
+            h = rotl(h, 27) * P1 + P4;
+        }
+        if (last - p >= 4) {
+            h ^= static_cast<uint64_t>(load32(p)) * P1;
+            h = rotl(h, 23) * P2 + P3;
+            p += 4;
+        }
+        for (; p < last; ++p) {
+            h ^= (*p) * P5;
+            h = rotl(h, 11) * P1;
+        }
+
+        h ^= h >> 33;
+        h *= P2;
+        h ^= h >> 29;
+        h *= P3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    // --- ChunkingReader ---
+
+    ChunkingReader::ChunkingReader(std::shared_ptr<Reader> r, ChunkerOptions options)
+        : r(std::move(r)), opts(options) {
+        // The window must fit inside the minimum chunk.
+        opts.minSize = std::max(opts.minSize, kWindow);
+        opts.maxSize = std::max(opts.maxSize, opts.minSize);
+        opts.avgSize = std::clamp(opts.avgSize, opts.minSize, opts.maxSize);
+
+        unsigned bits = 0;
+        while ((std::size_t{ 2 } << bits) <= opts.avgSize) ++bits;
+
+        // Normalized chunking (level 2): harder to cut before avgSize, easier after.
+        maskS = topMask(std::min(bits + 2, 63u));
+        maskL = topMask(bits > 2 ? bits - 2 : 1);
+
+        capacity = std::max<std::size_t>(opts.maxSize * 4, 256 * 1024);
+        buf.reset(new uint8_t[capacity]);
+    }
+
+    std::size_t ChunkingReader::cutPoint(const uint8_t* data, std::size_t size) const {
+        if (size <= opts.minSize) return size;
+
+        std::size_t n = std::min(size, opts.maxSize);
+        std::size_t normal = std::min(n, opts.avgSize);
+
+        // Position i tests the window ending at i, giving a chunk of i + 1 bytes.
+        std::size_t i = scan(data, opts.minSize - 1, normal - 1, maskS);
+        if (i == normal - 1) {
+            i = scan(data, normal - 1, n - 1, maskL);
+        }
+        return i + 1;
+    }
+
+    Result<std::size_t> ChunkingReader::fill() {
+        if (!r) {
+            return { 0, errors::New("ChunkingReader: null Reader") };
+        }
+
+        // Keep a whole max-size chunk contiguous ahead of `start`.
+        if (capacity - start < opts.maxSize) {
+            std::memmove(buf.get(), buf.get() + start, end - start);
+            end -= start;
+            start = 0;
+        }
+
+        while (!eof && end - start < opts.maxSize) {
+            auto res = r->read(buf.get() + end, capacity - end);
+            end += res.value;
+            if (!res.Ok()) {
+                if (errors::Is(res.err, ErrEOF)) {
+                    eof = true;
+                    break;
+                }
+                return { 0, res.err };
+            }
+        }
+        return { end - start };
+    }
+
+    Result<Chunk> ChunkingReader::next() {
+        // Finish a chunk that read() has only partly returned.
+        if (current.size > 0) {
+            Chunk rest = current;
+            current = Chunk{};
+            if (opts.fingerprint) rest.fingerprint = Fingerprint(rest.data, rest.size);
+            return { rest };
+        }
+        return nextChunk();
+    }
+
+    Result<Chunk> ChunkingReader::nextChunk() {
+        auto fres = fill();
+        if (!fres.Ok()) return { Chunk{}, fres.err };
+        if (start == end) return { Chunk{}, ErrEOF };
+
+        Chunk c;
+        c.data = buf.get() + start;
+        c.size = cutPoint(c.data, end - start);
+        c.offset = streamOffset;
+        if (opts.fingerprint) c.fingerprint = Fingerprint(c.data, c.size);
+
+        start += c.size;
+        streamOffset += c.size;
+        return { c };
+    }
+
+    Result<std::size_t> ChunkingReader::read(uint8_t* buffer, std::size_t size) {
+        if (!buffer) {
+            return { 0, errors::New("ChunkingReader: null buffer") };
+        }
+        if (size == 0) return { 0 };
+
+        if (current.size == 0) {
+            auto res = nextChunk();
+            if (!res.Ok()) return { 0, res.err };
+            current = res.value;
+        }
+
+        // `current` still points at valid data: fill() only runs from nextChunk().
+        std::size_t n = std::min(size, current.size);
+        std::memcpy(buffer, current.data, n);
+        current.data += n;
+        current.size -= n;
+        current.offset += n;
+        return { n };
+    }
+
+} // namespace gocxx::io
@@ -0,0 +1,269 @@
+#include "gocxx/io/file.h"
+#include "gocxx/io/io_errors.h"
+
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <climits>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace gocxx::io {
+
+    using gocxx::base::Result;
+
+    namespace {
+
+#ifndef _WIN32
+        // strerror_r is either XSI (returns int) or GNU (returns the message).
+        [[maybe_unused]] const char* strerrorResult(int rc, const char* buf) { return rc == 0 ? buf : "unknown error"; }
+        [[maybe_unused]] const char* strerrorResult(const char* msg, const char*) { return msg; }
+#endif
+
+        // Thread-safe strerror; MSVC also warns on plain strerror (C4996).
+        std::string errnoString(int errnum) {
+            char buf[256] = {};
+#ifdef _WIN32
+            if (strerror_s(buf, sizeof(buf), errnum) != 0) return "unknown error";
+            return buf;
+#else
+            return strerrorResult(strerror_r(errnum, buf, sizeof(buf)), buf);
+#endif
+        }
+
+        std::shared_ptr<errors::Error> pathError(const char* op, const std::string& name, int errnum) {
+            std::string msg = op;
+            if (!name.empty()) msg += " " + name;
+            return errors::New(msg + ": " + errnoString(errnum));
+        }
+
+#ifdef _WIN32
+        using offset_t = __int64;
+
+        offset_t sysSeek(int fd, offset_t offset, int origin) { return _lseeki64(fd, offset, origin); }
+        long long sysRead(int fd, uint8_t* buf, std::size_t n) {
+            return _read(fd, buf, static_cast<unsigned>(std::min<std::size_t>(n, INT_MAX)));
+        }
+        long long sysWrite(int fd, const uint8_t* buf, std::size_t n) {
+            return _write(fd, buf, static_cast<unsigned>(std::min<std::size_t>(n, INT_MAX)));
+        }
+
+        // No pread/pwrite: position, transfer, then restore the file offset.
+        long long sysReadAt(int fd, uint8_t* buf, std::size_t n, offset_t off) {
+            offset_t saved = sysSeek(fd, 0, SEEK_CUR);
+            if (saved < 0 || sysSeek(fd, off, SEEK_SET) < 0) return -1;
+            long long r = sysRead(fd, buf, n);
+            int e = errno;
+            sysSeek(fd, saved, SEEK_SET);
+            errno = e;
+            return r;
+        }
+        long long sysWriteAt(int fd, const uint8_t* buf, std::size_t n, offset_t off) {
+            offset_t saved = sysSeek(fd, 0, SEEK_CUR);
+            if (saved < 0 || sysSeek(fd, off, SEEK_SET) < 0) return -1;
+            long long r = sysWrite(fd, buf, n);
+            int e = errno;
+            sysSeek(fd, saved, SEEK_SET);
+            errno = e;
+            return r;
+        }
+#else
+        using offset_t = off_t;
+
+        offset_t sysSeek(int fd, offset_t offset, int origin) { return ::lseek(fd, offset, origin); }
+        long long sysRead(int fd, uint8_t* buf, std::size_t n) { return ::read(fd, buf, n); }
+        long long sysWrite(int fd, const uint8_t* buf, std::size_t n) { return ::write(fd, buf, n); }
+        long long sysReadAt(int fd, uint8_t* buf, std::size_t n, offset_t off) { return ::pread(fd, buf, n, off); }
+        long long sysWriteAt(int fd, const uint8_t* buf, std::size_t n, offset_t off) { return ::pwrite(fd, buf, n, off); }
+#endif
+
+        // SeekData/SeekHole for filesystems that cannot report holes:
+        // everything before EOF is data and EOF is the only hole.
+        Result<std::size_t> seekExtentFallback(int fd, const std::string& name, std::size_t offset, whence whence) {
+            offset_t cur = sysSeek(fd, 0, SEEK_CUR);
+            offset_t end = cur < 0 ? -1 : sysSeek(fd, 0, SEEK_END);
+            if (end < 0) return { 0, pathError("seek", name, errno) };
+
+            std::size_t size = static_cast<std::size_t>(end);
+            if (offset >= size) {
+                sysSeek(fd, cur, SEEK_SET);
+                return { 0, ErrEOF };
+            }
+
+            std::size_t target = whence == SeekData ? offset : size;
+            if (sysSeek(fd, static_cast<offset_t>(target), SEEK_SET) < 0) {
+                return { 0, pathError("seek", name, errno) };
+            }
+            return { target };
+        }
+
+    } // namespace
+
+    File::File(int fd, std::string name) : fd_(fd), name_(std::move(name)) {}
+
+    File::~File() {
+        close();
+    }
+
+    Result<std::shared_ptr<File>> File::Open(const std::string& name) {
+#ifdef _WIN32
+        int fd = _open(name.c_str(), _O_RDONLY | _O_BINARY);
+#else
+        int fd = ::open(name.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+        if (fd < 0) return { nullptr, pathError("open", name, errno) };
+        return { std::make_shared<File>(fd, name) };
+    }
+
+    Result<std::shared_ptr<File>> File::Create(const std::string& name) {
+#ifdef _WIN32
+        int fd = _open(name.c_str(), _O_RDWR | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        int fd = ::open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+#endif
+        if (fd < 0) return { nullptr, pathError("open", name, errno) };
+        return { std::make_shared<File>(fd, name) };
+    }
+
+    Result<std::size_t> File::read(uint8_t* buffer, std::size_t size) {
+        if (!buffer) return { 0, errors::New("File read: null buffer") };
+        if (size == 0) return { 0 };
+
+        long long n;
+        do {
+            n = sysRead(fd_, buffer, size);
+        } while (n < 0 && errno == EINTR);
+
+        if (n < 0) return { 0, pathError("read", name_, errno) };
+        if (n == 0) return { 0, ErrEOF };
+        return { static_cast<std::size_t>(n) };
+    }
+
+    Result<std::size_t> File::write(const uint8_t* buffer, std::size_t size) {
+        if (!buffer) return { 0, errors::New("File write: null buffer") };
+
+        std::size_t total = 0;
+        while (total < size) {
+            long long n = sysWrite(fd_, buffer + total, size - total);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return { total, pathError("write", name_, errno) };
+            }
+            if (n == 0) return { total, ErrShortWrite };
+            total += static_cast<std::size_t>(n);
+        }
+        return { total };
+    }
+
+    Result<std::size_t> File::readAt(uint8_t* buffer, std::size_t size, std::size_t offset) {
+        if (!buffer) return { 0, errors::New("File readAt: null buffer") };
+
+        // Like Go's ReadAt: a short read always comes with an error.
+        std::size_t total = 0;
+        while (total < size) {
+            long long n = sysReadAt(fd_, buffer + total, size - total, static_cast<offset_t>(offset + total));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return { total, pathError("read", name_, errno) };
+            }
+            if (n == 0) return { total, ErrEOF };
+            total += static_cast<std::size_t>(n);
+        }
+        return { total };
+    }
+
+    Result<std::size_t> File::writeAt(const uint8_t* buffer, std::size_t size, std::size_t offset) {
+        if (!buffer) return { 0, errors::New("File writeAt: null buffer") };
+
+        std::size_t total = 0;
+        while (total < size) {
+            long long n = sysWriteAt(fd_, buffer + total, size - total, static_cast<offset_t>(offset + total));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return { total, pathError("write", name_, errno) };
+            }
+            if (n == 0) return { total, ErrShortWrite };
+            total += static_cast<std::size_t>(n);
+        }
+        return { total };
+    }
+
+    Result<std::size_t> File::seek(std::size_t offset, whence whence) {
+        int origin;
+        switch (whence) {
+        case whence::SeekStart:
+            origin = SEEK_SET;
+            break;
+        case whence::SeekCurrent:
+            origin = SEEK_CUR;
+            break;
+        case whence::SeekEnd:
+            origin = SEEK_END;
+            break;
+        case whence::SeekData:
+        case whence::SeekHole:
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+            origin = whence == SeekData ? SEEK_DATA : SEEK_HOLE;
+            break;
+#else
+            return seekExtentFallback(fd_, name_, offset, whence);
+#endif
+        default:
+            return { 0, errors::New("File: Invalid seek origin") };
+        }
+
+        offset_t pos = sysSeek(fd_, static_cast<offset_t>(offset), origin);
+        if (pos < 0) {
+            int e = errno;
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+            // ENXIO: no data (or hole) at or after `offset`.
+            if (e == ENXIO) return { 0, ErrEOF };
+            if (e == EINVAL && (whence == SeekData || whence == SeekHole)) {
+                return seekExtentFallback(fd_, name_, offset, whence);
+            }
+#endif
+            return { 0, pathError("seek", name_, e) };
+        }
+        return { static_cast<std::size_t>(pos) };
+    }
+
+    Result<std::size_t> File::punchHole(std::size_t offset, std::size_t size) {
+        if (size == 0) return { 0 };
+#if defined(__linux__) && defined(FALLOC_FL_PUNCH_HOLE)
+        int rc;
+        do {
+            rc = ::fallocate(fd_, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                static_cast<offset_t>(offset), static_cast<offset_t>(size));
+        } while (rc < 0 && errno == EINTR);
+
+        if (rc < 0) {
+            if (errno == EOPNOTSUPP || errno == ENOSYS) {
+                return { 0, errors::Wrap("punch hole " + name_, ErrUnsupported) };
+            }
+            return { 0, pathError("punch hole", name_, errno) };
+        }
+        return { size };
+#else
+        (void)offset;
+        return { 0, errors::Wrap("punch hole " + name_, ErrUnsupported) };
+#endif
+    }
+
+    void File::close() {
+        if (fd_ < 0) return;
+#ifdef _WIN32
+        _close(fd_);
+#else
+        ::close(fd_);
+#endif
+        fd_ = -1;
+    }
+
+} // namespace gocxx::io
@@ -3,7 +3,17 @@
 
 #include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <cstring>
 #include <deque>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GOCXX_IO_SSE2 1
+#endif
 
 namespace gocxx::io {
 
@@ -11,6 +21,40 @@ namespace gocxx::io {
     using gocxx::errors::Error;
     using gocxx::base::Result;
 
+    namespace {
+
+        // True if all `size` bytes are zero. Checks 64 bytes per step so data
+        // blocks bail out early; zero blocks cost one pass at memory speed.
+        bool isZero(const uint8_t* data, std::size_t size) {
+            std::size_t i = 0;
+#ifdef GOCXX_IO_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 64 <= size; i += 64) {
+                const __m128i* p = reinterpret_cast<const __m128i*>(data + i);
+                __m128i acc = _mm_or_si128(
+                    _mm_or_si128(_mm_loadu_si128(p), _mm_loadu_si128(p + 1)),
+                    _mm_or_si128(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, zero)) != 0xFFFF) return false;
+            }
+#else
+            for (; i + 64 <= size; i += 64) {
+                uint64_t acc = 0;
+                for (std::size_t k = 0; k < 64; k += 8) {
+                    uint64_t word;
+                    std::memcpy(&word, data + i + k, sizeof(word));
+                    acc |= word;
+                }
+                if (acc != 0) return false;
+            }
+#endif
+            for (; i < size; ++i) {
+                if (data[i] != 0) return false;
+            }
+            return true;
+        }
+
+    } // namespace
+
     Result<std::size_t> Copy(std::shared_ptr<Writer> dest, std::shared_ptr<Reader> source) {
         constexpr std::size_t bufferSize = 8192;
         std::unique_ptr<uint8_t[]> buffer(new uint8_t[bufferSize]);
@@ -33,6 +77,169 @@ namespace gocxx::io {
         return {totalBytes,nullptr};
     }
 
+    Result<std::size_t> CopySparse(std::shared_ptr<Writer> dst, std::shared_ptr<Reader> src) {
+        constexpr std::size_t bufferSize = 128 * 1024;
+        constexpr std::size_t blockSize = 4096;
+        std::unique_ptr<uint8_t[]> buffer(new uint8_t[bufferSize]);
+        std::vector<uint8_t> zeros(blockSize, 0);
+
+        auto srcSeeker = std::dynamic_pointer_cast<Seeker>(src);
+        auto dstSeeker = std::dynamic_pointer_cast<Seeker>(dst);
+
+        // A Seeker may still be unseekable (a File over a pipe or tty):
+        // probe once and write zeros out if it cannot seek.
+        std::size_t dstPos = 0;
+        if (dstSeeker) {
+            auto probe = dstSeeker->seek(0, SeekCurrent);
+            if (probe.Ok()) {
+                dstPos = probe.value;
+            } else {
+                dstSeeker = nullptr;
+            }
+        }
+
+        // Skipped ranges below dst's current end may hold old data; punch them.
+        // Everything at or past dstEnd already reads as zero.
+        auto puncher = dstSeeker ? std::dynamic_pointer_cast<HolePuncher>(dst) : nullptr;
+        std::size_t dstEnd = std::numeric_limits<std::size_t>::max();
+        if (puncher) {
+            auto eres = dstSeeker->seek(0, SeekEnd);
+            if (eres.Ok()) dstEnd = eres.value;
+            auto back = dstSeeker->seek(dstPos, SeekStart);
+            if (!back.Ok()) return { 0, back.err };
+        }
+
+        std::size_t total = 0;      // logical bytes, holes included
+        std::size_t pending = 0;    // zeros owed to dst
+
+        auto writeZeros = [&](std::size_t n) -> Result<std::size_t> {
+            while (n > 0) {
+                auto wres = dst->write(zeros.data(), std::min(n, zeros.size()));
+                if (!wres.Ok()) return { 0, wres.err };
+                n -= wres.value;
+            }
+            return { 0 };
+        };
+
+        // Seeks dst over the pending zeros, or writes them if dst cannot seek.
+        // `terminal` writes the last zero byte so a trailing hole still sets the size.
+        auto flushZeros = [&](bool terminal) -> Result<std::size_t> {
+            if (pending == 0) return { 0 };
+            std::size_t skip = dstSeeker ? pending - (terminal ? 1 : 0) : 0;
+
+            std::size_t fill = 0;   // live bytes that could not be punched
+            if (skip > 0 && puncher && dstPos < dstEnd) {
+                std::size_t live = std::min(skip, dstEnd - dstPos);
+                if (!puncher->punchHole(dstPos, live).Ok()) fill = live;
+            }
+
+            auto zres = writeZeros(fill);
+            if (!zres.Ok()) return zres;
+            if (skip > fill) {
+                auto sres = dstSeeker->seek(skip - fill, SeekCurrent);
+                if (!sres.Ok()) return { 0, sres.err };
+            }
+            zres = writeZeros(pending - skip);
+            if (!zres.Ok()) return zres;
+
+            dstPos += pending;
+            pending = 0;
+            return { 0 };
+        };
+
+        // Copies up to `limit` bytes from src's current position, turning
+        // all-zero blocks into pending zeros when dst can seek over them.
+        auto copyExtent = [&](std::size_t limit) -> Result<std::size_t> {
+            while (limit > 0) {
+                auto rres = src->read(buffer.get(), std::min(limit, bufferSize));
+                std::size_t n = rres.value;
+                std::size_t runStart = 0;
+                for (std::size_t off = 0; off < n; off += blockSize) {
+                    std::size_t len = std::min(blockSize, n - off);
+                    if (!dstSeeker || !isZero(buffer.get() + off, len)) continue;
+
+                    if (off > runStart) {
+                        auto fres = flushZeros(false);
+                        if (!fres.Ok()) return fres;
+                        auto wres = dst->write(buffer.get() + runStart, off - runStart);
+                        if (!wres.Ok()) return { 0, wres.err };
+                        dstPos += wres.value;
+                    }
+                    pending += len;
+                    runStart = off + len;
+                }
+                if (n > runStart) {
+                    auto fres = flushZeros(false);
+                    if (!fres.Ok()) return fres;
+                    auto wres = dst->write(buffer.get() + runStart, n - runStart);
+                    if (!wres.Ok()) return { 0, wres.err };
+                    dstPos += wres.value;
+                }
+                total += n;
+                limit -= n;
+
+                if (!rres.Ok()) {
+                    if (errors::Is(rres.err, ErrEOF)) break;
+                    return { 0, rres.err };
+                }
+            }
+            return { 0 };
+        };
+
+        // Walk data extents with SeekData/SeekHole; sources that cannot report
+        // them are copied sequentially, still skipping zero blocks.
+        bool sequential = true;
+        if (srcSeeker) {
+            auto cur = srcSeeker->seek(0, SeekCurrent);
+            auto last = srcSeeker->seek(0, SeekEnd);
+            if (cur.Ok() && last.Ok()) {
+                std::size_t pos = cur.value;
+                const std::size_t end = last.value;
+                sequential = false;
+
+                while (pos < end) {
+                    auto data = srcSeeker->seek(pos, SeekData);
+                    if (!data.Ok()) {
+                        if (errors::Is(data.err, ErrEOF)) {
+                            pending += end - pos;
+                            total += end - pos;
+                            pos = end;
+                            break;
+                        }
+                        if (pos == cur.value) {
+                            sequential = true;
+                            break;
+                        }
+                        return { total, data.err };
+                    }
+                    auto hole = srcSeeker->seek(data.value, SeekHole);
+                    if (!hole.Ok()) return { total, hole.err };
+                    auto rewind = srcSeeker->seek(data.value, SeekStart);
+                    if (!rewind.Ok()) return { total, rewind.err };
+
+                    pending += data.value - pos;
+                    total += data.value - pos;
+
+                    auto cres = copyExtent(hole.value - data.value);
+                    if (!cres.Ok()) return { total, cres.err };
+                    pos = hole.value;
+                }
+
+                auto sres = srcSeeker->seek(pos, SeekStart);
+                if (!sres.Ok()) return { total, sres.err };
+            }
+        }
+
+        if (sequential) {
+            auto cres = copyExtent(std::numeric_limits<std::size_t>::max());
+            if (!cres.Ok()) return { total, cres.err };
+        }
+
+        auto fres = flushZeros(true);
+        if (!fres.Ok()) return { total, fres.err };
+        return { total };
+    }
+
     Result<std::size_t> CopyBuffer(std::shared_ptr<Writer> dst, std::shared_ptr<Reader> src, uint8_t* buf, std::size_t size) {
         if (!buf || size == 0) {
             return { 0, ErrUnknownIO };
@@ -216,6 +423,124 @@ namespace gocxx::io {
             return { newOffset - base }; // relative offset
         }
 
+        // --- SparseWriter ---
+
+        SparseWriter::SparseWriter(std::shared_ptr<WriterAt> w, std::size_t blockSize)
+            : w(std::move(w)), blockSize(blockSize ? blockSize : 4096) {
+            puncher = std::dynamic_pointer_cast<HolePuncher>(this->w);
+        }
+
+        gocxx::base::Result<std::size_t> SparseWriter::flushHole() {
+            if (holeSize == 0) return { 0 };
+
+            std::size_t start = holeStart;
+            std::size_t size = holeSize;
+            holeSize = 0;
+            if (!puncher) return { 0 };
+
+            auto pres = puncher->punchHole(start, size);
+            if (pres.Ok()) return { 0 };
+
+            // No hole support on this target: fall back to writing the zeros.
+            std::vector<uint8_t> zeros(std::min(size, blockSize), 0);
+            while (size > 0) {
+                auto wres = w->writeAt(zeros.data(), std::min(size, zeros.size()), start);
+                if (!wres.Ok()) return wres;
+                start += wres.value;
+                size -= wres.value;
+            }
+            return { 0 };
+        }
+
+        gocxx::base::Result<std::size_t> SparseWriter::write(const uint8_t* buffer, std::size_t size) {
+            if (!w) {
+                return { 0, errors::New("SparseWriter: null WriterAt") };
+            }
+            if (!buffer) {
+                return { 0, errors::New("SparseWriter: null buffer") };
+            }
+
+            std::size_t done = 0;
+            std::size_t runStart = 0;
+            std::shared_ptr<errors::Error> err = nullptr;
+
+            // Writes the non-zero bytes [runStart, runEnd) in one call.
+            auto writeRun = [&](std::size_t runEnd) {
+                if (runEnd == runStart) return true;
+                auto hres = flushHole();
+                if (!hres.Ok()) {
+                    err = hres.err;
+                    done = runStart;
+                    return false;
+                }
+                std::size_t at = currentOffset + runStart;
+                auto wres = w->writeAt(buffer + runStart, runEnd - runStart, at);
+                physicalEnd = std::max(physicalEnd, at + wres.value);
+                if (!wres.Ok()) {
+                    err = wres.err;
+                    done = runStart + wres.value;
+                    return false;
+                }
+                return true;
+            };
+
+            // Split on block boundaries of the destination offset so skipped
+            // blocks line up with filesystem blocks.
+            while (done < size) {
+                std::size_t at = currentOffset + done;
+                std::size_t len = std::min(size - done, blockSize - at % blockSize);
+                if (isZero(buffer + done, len)) {
+                    if (!writeRun(done)) break;
+                    if (holeSize > 0 && holeStart + holeSize != at) {
+                        auto hres = flushHole();
+                        if (!hres.Ok()) {
+                            err = hres.err;
+                            break;
+                        }
+                    }
+                    if (holeSize == 0) holeStart = at;
+                    holeSize += len;
+                    runStart = done + len;
+                }
+                done += len;
+            }
+            if (!err) writeRun(size);
+
+            currentOffset += done;
+            logicalEnd = std::max(logicalEnd, currentOffset);
+            return { done, err };
+        }
+
+        gocxx::base::Result<std::size_t> SparseWriter::seek(std::size_t offset, whence whence) {
+            switch (whence) {
+            case whence::SeekStart:
+                currentOffset = offset;
+                break;
+            case whence::SeekCurrent:
+                currentOffset += offset;
+                break;
+            case whence::SeekEnd:
+                currentOffset = logicalEnd + offset;
+                break;
+            default:
+                return { 0, errors::New("SparseWriter: Invalid seek origin") };
+            }
+            return { currentOffset };
+        }
+
+        gocxx::base::Result<std::size_t> SparseWriter::finish() {
+            auto hres = flushHole();
+            if (!hres.Ok()) return hres;
+
+            if (logicalEnd > physicalEnd) {
+                const uint8_t zero = 0;
+                auto wres = w->writeAt(&zero, 1, logicalEnd - 1);
+                if (!wres.Ok()) return wres;
+                physicalEnd = logicalEnd;
+            }
+            return { logicalEnd };
+        }
+
         // --- SharedPipe ---
 
         class SharedPipe {
@@ -328,4 +653,336 @@ namespace gocxx::io {
             };
         }
 
+        // --- SharedMessagePipe ---
+
+        constexpr std::size_t kCacheLine = 64;
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4324)   // padding from alignas is intended
+#endif
+
+        // Single-producer/single-consumer queue of messages. The consumer keeps
+        // a dummy head node; the producer appends after the tail. Producer and
+        // consumer fields sit on separate cache lines so pushes and pops don't
+        // bounce one line between the two threads.
+        struct alignas(kCacheLine) MessageLane {
+            struct Node {
+                std::vector<uint8_t> data;
+                std::atomic<Node*> next{ nullptr };
+            };
+
+            // Consumer side. `retired` is written once, by the writer's destructor.
+            Node* head;
+            MessageLane* nextLane = nullptr;
+            std::atomic<bool> retired{ false };   // writer gone; freed once drained
+
+            // Producer side.
+            alignas(kCacheLine) Node* tail;
+            std::atomic<bool> pushing{ false };
+
+            MessageLane() : head(new Node), tail(head) {}
+
+            ~MessageLane() {
+                while (head) {
+                    Node* n = head->next.load(std::memory_order_relaxed);
+                    delete head;
+                    head = n;
+                }
+            }
+
+            void push(std::vector<uint8_t>&& msg) {
+                Node* n = new Node;
+                n->data = std::move(msg);
+                tail->next.store(n, std::memory_order_release);
+                tail = n;
+            }
+
+            Node* front() const {
+                return head->next.load(std::memory_order_acquire);
+            }
+
+            // The popped node becomes the new dummy head.
+            void pop() {
+                Node* n = head->next.load(std::memory_order_acquire);
+                delete head;
+                head = n;
+            }
+        };
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+        class SharedMessagePipe {
+        public:
+            std::atomic<MessageLane*> lanes{ nullptr };
+            MessageLane* cursor = nullptr;    // consumer round-robin position
+
+            std::mutex mtx;
+            std::condition_variable cv;
+            std::atomic<bool> waiting{ false };
+
+            std::atomic<bool> closed{ false };
+            std::shared_ptr<errors::Error> closeError = nullptr;
+
+            ~SharedMessagePipe() {
+                MessageLane* l = lanes.load(std::memory_order_relaxed);
+                while (l) {
+                    MessageLane* n = l->nextLane;
+                    delete l;
+                    l = n;
+                }
+            }
+
+            MessageLane* newLane() {
+                MessageLane* l = new MessageLane;
+                l->nextLane = lanes.load(std::memory_order_relaxed);
+                while (!lanes.compare_exchange_weak(l->nextLane, l,
+                    std::memory_order_release, std::memory_order_relaxed)) {
+                }
+                return l;
+            }
+
+            gocxx::base::Result<std::size_t> write(MessageLane* lane, const uint8_t* data, std::size_t size) {
+                if (!data) return { 0, errors::New("MessagePipe write: null buffer") };
+
+                // Pairs with quiesce(): either the consumer sees us pushing, or we see closed.
+                lane->pushing.store(true);
+                if (closed.load()) {
+                    lane->pushing.store(false, std::memory_order_release);
+                    return { 0, errors::New("MessagePipe write: closed") };
+                }
+                lane->push(std::vector<uint8_t>(data, data + size));
+                lane->pushing.store(false, std::memory_order_release);
+
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (waiting.load(std::memory_order_relaxed)) {
+                    std::lock_guard lock(mtx);
+                    cv.notify_one();
+                }
+                return { size };
+            }
+
+            // Visits lanes once, starting at the round-robin cursor.
+            // `fn` returns false to stop; the cursor is then left on that lane.
+            template <typename Fn>
+            void forEachLane(Fn&& fn) {
+                MessageLane* first = lanes.load(std::memory_order_acquire);
+                MessageLane* start = cursor ? cursor : first;
+                MessageLane* l = start;
+                while (l) {
+                    MessageLane* next = l->nextLane ? l->nextLane : first;
+                    if (next == start) next = nullptr;
+                    if (!fn(l)) {
+                        cursor = l;
+                        return;
+                    }
+                    cursor = next;
+                    l = next;
+                }
+            }
+
+            // Unlinks and frees lanes whose writer is gone and whose messages
+            // have all been read. Producers only ever push at the list head, so
+            // interior lanes can be unlinked without synchronization.
+            void reap() {
+                MessageLane* prev = nullptr;
+                MessageLane* l = lanes.load(std::memory_order_acquire);
+                while (l) {
+                    MessageLane* next = l->nextLane;
+                    if (l->retired.load(std::memory_order_acquire) && !l->front()) {
+                        bool unlinked = true;
+                        if (prev) {
+                            prev->nextLane = next;
+                        } else {
+                            MessageLane* expected = l;
+                            unlinked = lanes.compare_exchange_strong(expected, next,
+                                std::memory_order_acq_rel, std::memory_order_acquire);
+                        }
+                        if (unlinked) {
+                            if (cursor == l) cursor = next;
+                            delete l;
+                            l = next;
+                            continue;
+                        }
+                    }
+                    prev = l;
+                    l = next;
+                }
+            }
+
+            std::size_t laneCount() {
+                reap();
+                std::size_t n = 0;
+                for (MessageLane* l = lanes.load(std::memory_order_acquire); l; l = l->nextLane) ++n;
+                return n;
+            }
+
+            bool ready() {
+                for (MessageLane* l = lanes.load(std::memory_order_acquire); l; l = l->nextLane) {
+                    if (l->front()) return true;
+                }
+                return false;
+            }
+
+            // Waits for writers that raced with close() to finish their push.
+            void quiesce() {
+                for (MessageLane* l = lanes.load(std::memory_order_acquire); l; l = l->nextLane) {
+                    while (l->pushing.load()) std::this_thread::yield();
+                }
+            }
+
+            // Blocks until a message is queued, or returns the close error once drained.
+            gocxx::base::Result<std::size_t> await() {
+                reap();
+                while (true) {
+                    if (ready()) return { 0 };
+
+                    if (closed.load()) {
+                        quiesce();
+                        if (ready()) return { 0 };
+                        return { 0, closeError ? closeError : ErrEOF };
+                    }
+
+                    std::unique_lock lock(mtx);
+                    waiting.store(true);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    cv.wait(lock, [this] { return closed.load() || ready(); });
+                    waiting.store(false, std::memory_order_relaxed);
+                }
+            }
+
+            gocxx::base::Result<std::size_t> read(uint8_t* out, std::size_t size) {
+                if (!out) return { 0, errors::New("MessagePipe read: null buffer") };
+
+                auto res = await();
+                if (!res.Ok()) return res;
+
+                gocxx::base::Result<std::size_t> result{ 0 };
+                MessageLane* taken = nullptr;
+                forEachLane([&](MessageLane* l) {
+                    MessageLane::Node* n = l->front();
+                    if (!n) return true;
+                    if (n->data.size() > size) {
+                        result = { 0, ErrShortBuffer };
+                        return false;
+                    }
+                    if (!n->data.empty()) std::memcpy(out, n->data.data(), n->data.size());
+                    result = { n->data.size() };
+                    l->pop();
+                    taken = l;
+                    return false;
+                });
+                if (taken) cursor = taken->nextLane;
+                return result;
+            }
+
+            gocxx::base::Result<std::size_t> readBatch(std::vector<std::vector<uint8_t>>& out, std::size_t max) {
+                if (max == 0) return { 0 };
+
+                auto res = await();
+                if (!res.Ok()) return res;
+
+                std::size_t count = 0;
+                MessageLane* last = nullptr;
+                forEachLane([&](MessageLane* l) {
+                    while (count < max) {
+                        MessageLane::Node* n = l->front();
+                        if (!n) break;
+                        out.push_back(std::move(n->data));
+                        l->pop();
+                        ++count;
+                    }
+                    last = l;
+                    return count < max;
+                });
+                if (count == max) cursor = last->nextLane;
+                return { count };
+            }
+
+            gocxx::base::Result<std::size_t> close(const std::shared_ptr<errors::Error>& err) {
+                std::lock_guard lock(mtx);
+                if (!closed.load(std::memory_order_relaxed)) {
+                    closeError = err;
+                    closed.store(true);
+                    cv.notify_all();
+                }
+                return { 0 };
+            }
+        };
+
+        // --- MessagePipeReaderImpl ---
+
+        class MessagePipeReaderImpl : public MessagePipeReader {
+        public:
+            explicit MessagePipeReaderImpl(std::shared_ptr<SharedMessagePipe> pipe) : pipe_(std::move(pipe)) {}
+
+            gocxx::base::Result<std::size_t> read(uint8_t* buffer, std::size_t size) override {
+                return pipe_->read(buffer, size);
+            }
+
+            gocxx::base::Result<std::size_t> readBatch(std::vector<std::vector<uint8_t>>& out, std::size_t max) override {
+                return pipe_->readBatch(out, max);
+            }
+
+            std::size_t lanes() override {
+                return pipe_->laneCount();
+            }
+
+            gocxx::base::Result<std::size_t> close() override {
+                return pipe_->close(nullptr);
+            }
+
+            gocxx::base::Result<std::size_t> closeWithError(std::shared_ptr<errors::Error> err) override {
+                return pipe_->close(std::move(err));
+            }
+
+        private:
+            std::shared_ptr<SharedMessagePipe> pipe_;
+        };
+
+        // --- MessagePipeWriterImpl ---
+
+        class MessagePipeWriterImpl : public MessagePipeWriter {
+        public:
+            explicit MessagePipeWriterImpl(std::shared_ptr<SharedMessagePipe> pipe)
+                : pipe_(std::move(pipe)), lane_(pipe_->newLane()) {
+            }
+
+            ~MessagePipeWriterImpl() override {
+                lane_->retired.store(true, std::memory_order_release);
+            }
+
+            gocxx::base::Result<std::size_t> write(const uint8_t* buffer, std::size_t size) override {
+                return pipe_->write(lane_, buffer, size);
+            }
+
+            gocxx::base::Result<std::size_t> close() override {
+                return pipe_->close(nullptr);
+            }
+
+            gocxx::base::Result<std::size_t> closeWithError(std::shared_ptr<errors::Error> err) override {
+                return pipe_->close(std::move(err));
+            }
+
+            std::shared_ptr<MessagePipeWriter> newWriter() override {
+                return std::make_shared<MessagePipeWriterImpl>(pipe_);
+            }
+
+        private:
+            std::shared_ptr<SharedMessagePipe> pipe_;
+            MessageLane* lane_;
+        };
+
+        // --- MessagePipe creation ---
+
+        std::pair<std::shared_ptr<MessagePipeReader>, std::shared_ptr<MessagePipeWriter>> MessagePipe() {
+            auto pipe = std::make_shared<SharedMessagePipe>();
+            return {
+                std::make_shared<MessagePipeReaderImpl>(pipe),
+                std::make_shared<MessagePipeWriterImpl>(pipe)
+            };
+        }
+
     } // namespace gocxx::io
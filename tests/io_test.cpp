@@ -1,12 +1,24 @@
 #include <gtest/gtest.h>
 #include <gocxx/io/io.h>
 #include <gocxx/io/io_errors.h>
+#include <gocxx/io/file.h>
+#include <gocxx/io/chunking.h>
 #include <gocxx/errors/errors.h>
 #include <memory>
 #include <string>
 #include <vector>
 #include <thread>
 #include <cstring>
+#include <filesystem>
+#include <set>
+#include <random>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#endif
 
 using namespace gocxx::io;
 using gocxx::base::Result;
@@ -46,6 +58,27 @@ public:
     std::vector<uint8_t> out;
 };
 
+// Unique path in the temp directory, removed when it goes out of scope.
+// Declare it before any File on the path so the File is closed first.
+class TempPath {
+public:
+    explicit TempPath(const std::string& prefix) {
+        std::random_device rd;
+        std::string name = prefix + "_" + std::to_string(rd()) + std::to_string(rd()) + ".bin";
+        path_ = (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    ~TempPath() {
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+    }
+
+    const std::string& str() const { return path_; }
+
+private:
+    std::string path_;
+};
+
 // ------------------- Tests -------------------
 
 TEST(IOTest, CopyCopiesAllData) {
@@ -190,3 +223,498 @@ TEST(IOTest, ReadFullFailsOnEOF) {
     EXPECT_LT(res.value, buf.size());
     EXPECT_EQ(std::string(buf.begin(), buf.begin() + res.value), "123");
 }
+
+TEST(IOTest, MessagePipePreservesBoundaries) {
+    auto [r, w] = MessagePipe();
+
+    WriteString(w, "first");
+    WriteString(w, "second");
+    w->close();
+
+    std::vector<uint8_t> buf(3);
+    auto shortRes = r->read(buf.data(), buf.size());
+    EXPECT_FALSE(shortRes.Ok());
+    EXPECT_TRUE(Is(shortRes.err, ErrShortBuffer));
+
+    buf.resize(128);
+    auto res = r->read(buf.data(), buf.size());
+    EXPECT_TRUE(res.Ok());
+    EXPECT_EQ(std::string(buf.begin(), buf.begin() + res.value), "first");
+
+    res = r->read(buf.data(), buf.size());
+    EXPECT_TRUE(res.Ok());
+    EXPECT_EQ(std::string(buf.begin(), buf.begin() + res.value), "second");
+
+    auto eof = r->read(buf.data(), buf.size());
+    EXPECT_FALSE(eof.Ok());
+    EXPECT_TRUE(Is(eof.err, ErrEOF));
+}
+
+TEST(IOTest, MessagePipeReadBatchFromManyProducers) {
+    auto [r, w] = MessagePipe();
+    constexpr int producers = 4;
+    constexpr int perProducer = 1000;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([lane = w->newWriter(), p] {
+            for (int i = 0; i < perProducer; ++i) {
+                std::string msg = std::to_string(p) + ":" + std::to_string(i);
+                auto res = WriteString(lane, msg);
+                EXPECT_TRUE(res.Ok());
+            }
+        });
+    }
+
+    std::vector<int> next(producers, 0);
+    std::size_t received = 0;
+    std::vector<std::vector<uint8_t>> batch;
+    while (received < producers * perProducer) {
+        batch.clear();
+        auto res = r->readBatch(batch, 64);
+        ASSERT_TRUE(res.Ok());
+        ASSERT_EQ(res.value, batch.size());
+        for (const auto& m : batch) {
+            std::string s(m.begin(), m.end());
+            auto sep = s.find(':');
+            int p = std::stoi(s.substr(0, sep));
+            EXPECT_EQ(std::stoi(s.substr(sep + 1)), next[p]++);  // per-producer FIFO
+        }
+        received += batch.size();
+    }
+
+    for (auto& t : threads) t.join();
+    w->close();
+
+    batch.clear();
+    auto eof = r->readBatch(batch, 64);
+    EXPECT_TRUE(Is(eof.err, ErrEOF));
+    EXPECT_TRUE(batch.empty());
+}
+
+TEST(IOTest, MessagePipeCloseWithErrorReachesReader) {
+    auto [r, w] = MessagePipe();
+    auto custom = gocxx::errors::New("producer failed");
+
+    WriteString(w, "last");
+    w->closeWithError(custom);
+
+    auto after = WriteString(w, "dropped");
+    EXPECT_FALSE(after.Ok());
+
+    std::vector<std::vector<uint8_t>> batch;
+    auto res = r->readBatch(batch, 8);
+    EXPECT_TRUE(res.Ok());
+    ASSERT_EQ(batch.size(), 1u);
+    EXPECT_EQ(std::string(batch[0].begin(), batch[0].end()), "last");
+
+    auto err = r->readBatch(batch, 8);
+    EXPECT_FALSE(err.Ok());
+    EXPECT_TRUE(Is(err.err, custom));
+}
+
+TEST(IOTest, SparseWriterSkipsZeroBlocks) {
+    class RecordingWriterAt : public WriterAt {
+    public:
+        std::vector<uint8_t> data;
+        std::size_t calls = 0;
+        std::size_t bytes = 0;
+
+        Result<std::size_t> writeAt(const uint8_t* buf, std::size_t size, std::size_t offset) override {
+            if (offset + size > data.size()) data.resize(offset + size, 0);
+            std::copy(buf, buf + size, data.begin() + offset);
+            ++calls;
+            bytes += size;
+            return size;
+        }
+    };
+
+    auto target = std::make_shared<RecordingWriterAt>();
+    SparseWriter sparse(target, 16);
+
+    std::vector<uint8_t> input(64, 0);
+    input[3] = 'a';    // block 0 has data
+    input[40] = 'b';   // block 2 has data, blocks 1 and 3 are zero
+
+    auto res = sparse.write(input.data(), input.size());
+    EXPECT_TRUE(res.Ok());
+    EXPECT_EQ(res.value, input.size());
+    EXPECT_EQ(target->bytes, 32u);
+
+    auto fin = sparse.finish();
+    EXPECT_TRUE(fin.Ok());
+    EXPECT_EQ(fin.value, 64u);
+    EXPECT_EQ(target->data, input);
+}
+
+TEST(IOTest, SparseWriterClearsOldFileContents) {
+    TempPath path("gocxx_io_sparse_writer");
+    constexpr std::size_t oldSize = 64 * 1024;
+    constexpr std::size_t newSize = 72 * 1024;
+
+    auto file = File::Create(path.str());
+    ASSERT_TRUE(file.Ok());
+    std::vector<uint8_t> old(oldSize, 0xAA);
+    ASSERT_TRUE(file.value->write(old.data(), old.size()).Ok());
+
+    // Data in the first block only; the zero tail runs past the old end, so
+    // finish() has to extend the file after the punch.
+    std::vector<uint8_t> input(newSize, 0);
+    std::memcpy(input.data(), "head", 4);
+
+    SparseWriter sparse(file.value, 4096);
+    auto res = sparse.write(input.data(), input.size());
+    EXPECT_TRUE(res.Ok());
+    EXPECT_EQ(res.value, newSize);
+
+    auto fin = sparse.finish();
+    EXPECT_TRUE(fin.Ok());
+    EXPECT_EQ(fin.value, newSize);
+
+    auto end = file.value->seek(0, SeekEnd);
+    EXPECT_TRUE(end.Ok());
+    EXPECT_EQ(end.value, newSize);
+
+    std::vector<uint8_t> got(newSize);
+    EXPECT_TRUE(file.value->readAt(got.data(), got.size(), 0).Ok());
+    EXPECT_EQ(got, input);
+}
+
+TEST(IOTest, SparseWriterWritesZerosWhenPunchFails) {
+    class NoHoleWriterAt : public WriterAt, public HolePuncher {
+    public:
+        std::vector<uint8_t> data = std::vector<uint8_t>(64, 0xAA);
+
+        Result<std::size_t> writeAt(const uint8_t* buf, std::size_t size, std::size_t offset) override {
+            if (offset + size > data.size()) data.resize(offset + size, 0);
+            std::copy(buf, buf + size, data.begin() + offset);
+            return size;
+        }
+
+        Result<std::size_t> punchHole(std::size_t, std::size_t) override {
+            return { 0, ErrUnsupported };
+        }
+    };
+
+    auto target = std::make_shared<NoHoleWriterAt>();
+    SparseWriter sparse(target, 16);
+
+    std::vector<uint8_t> input(64, 0);
+    input[0] = 'a';
+    input[63] = 'z';
+
+    EXPECT_TRUE(sparse.write(input.data(), input.size()).Ok());
+    EXPECT_TRUE(sparse.finish().Ok());
+    EXPECT_EQ(target->data, input);
+}
+
+TEST(IOTest, CopySparseWithoutSeekersCopiesEveryByte) {
+    std::string data("head");
+    data.append(10000, '\0');
+    data.append("tail");
+    data.append(5000, '\0');
+
+    auto reader = std::make_shared<StringReader>(data);
+    auto writer = std::make_shared<VectorWriter>();
+
+    auto res = CopySparse(writer, reader);
+    EXPECT_TRUE(res.Ok());
+    EXPECT_EQ(res.value, data.size());
+    EXPECT_EQ(writer->str(), data);
+}
+
+TEST(IOTest, CopySparseKeepsFileHoles) {
+    TempPath srcPath("gocxx_io_sparse_src");
+    TempPath dstPath("gocxx_io_sparse_dst");
+    constexpr std::size_t mib = 1024 * 1024;
+
+    {
+        auto src = File::Create(srcPath.str());
+        ASSERT_TRUE(src.Ok());
+        std::string a = "data at 1MiB", b = "data at 3MiB";
+        src.value->seek(mib, SeekStart);
+        WriteString(src.value, a);
+        src.value->seek(3 * mib, SeekStart);
+        WriteString(src.value, b);
+        const uint8_t zero = 0;
+        src.value->writeAt(&zero, 1, 4 * mib - 1);   // extends the file past a trailing hole
+    }
+
+    auto src = File::Open(srcPath.str());
+    auto dst = File::Create(dstPath.str());
+    ASSERT_TRUE(src.Ok());
+    ASSERT_TRUE(dst.Ok());
+
+    auto res = CopySparse(dst.value, src.value);
+    EXPECT_TRUE(res.Ok());
+    EXPECT_EQ(res.value, 4 * mib);
+
+    auto end = dst.value->seek(0, SeekEnd);
+    EXPECT_EQ(end.value, 4 * mib);
+
+    std::vector<uint8_t> want(4 * mib), got(4 * mib);
+    EXPECT_TRUE(src.value->readAt(want.data(), want.size(), 0).Ok());
+    EXPECT_TRUE(dst.value->readAt(got.data(), got.size(), 0).Ok());
+    EXPECT_EQ(want, got);
+
+    // Where the platform reports holes, the leading hole must not have been written.
+    auto srcHole = src.value->seek(0, SeekHole);
+    if (!srcHole.Ok() || srcHole.value >= mib) {
+        GTEST_SKIP() << "holes are not reported on this platform";
+    }
+    auto data = dst.value->seek(0, SeekData);
+    EXPECT_TRUE(data.Ok());
+    EXPECT_GT(data.value, 0u);
+}
+
+namespace {
+
+    std::string randomData(std::size_t n, uint32_t seed) {
+        std::string s(n, '\0');
+        for (auto& c : s) {
+            seed = seed * 1664525u + 1013904223u;
+            c = static_cast<char>(seed >> 24);
+        }
+        return s;
+    }
+
+    // Returns at most `step` bytes per call to exercise refills.
+    class TrickleReader : public Reader {
+    public:
+        TrickleReader(const std::string& data, std::size_t step) : data_(data), step_(step) {}
+
+        Result<std::size_t> read(uint8_t* buffer, std::size_t size) override {
+            if (offset_ >= data_.size()) return { 0, ErrEOF };
+            std::size_t n = std::min({ size, step_, data_.size() - offset_ });
+            std::memcpy(buffer, data_.data() + offset_, n);
+            offset_ += n;
+            return n;
+        }
+
+    private:
+        std::string data_;
+        std::size_t step_;
+        std::size_t offset_ = 0;
+    };
+
+    std::vector<Chunk> chunkAll(ChunkingReader& cr, std::string* joined = nullptr) {
+        std::vector<Chunk> chunks;
+        while (true) {
+            auto res = cr.next();
+            if (!res.Ok()) {
+                EXPECT_TRUE(Is(res.err, ErrEOF));
+                break;
+            }
+            if (joined) joined->append(reinterpret_cast<const char*>(res.value.data), res.value.size);
+            chunks.push_back(res.value);
+        }
+        return chunks;
+    }
+
+} // namespace
+
+TEST(IOTest, ChunkingReaderRespectsSizeLimits) {
+    std::string data = randomData(1 << 20, 7);
+    ChunkerOptions opts;
+    opts.minSize = 1024;
+    opts.avgSize = 4096;
+    opts.maxSize = 16384;
+    ChunkingReader cr(std::make_shared<StringReader>(data), opts);
+
+    std::string joined;
+    auto chunks = chunkAll(cr, &joined);
+    EXPECT_EQ(joined, data);
+
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        EXPECT_EQ(chunks[i].offset, offset);
+        EXPECT_LE(chunks[i].size, opts.maxSize);
+        if (i + 1 < chunks.size()) {
+            EXPECT_GE(chunks[i].size, opts.minSize);
+        }
+        offset += chunks[i].size;
+    }
+    EXPECT_GT(chunks.size(), data.size() / opts.maxSize);
+    EXPECT_LT(chunks.size(), data.size() / opts.minSize);
+}
+
+TEST(IOTest, ChunkingReaderBoundariesIgnoreReadSizes) {
+    std::string data = randomData(512 * 1024, 11);
+    ChunkerOptions opts;
+    opts.fingerprint = true;
+
+    ChunkingReader whole(std::make_shared<StringReader>(data), opts);
+    ChunkingReader trickle(std::make_shared<TrickleReader>(data, 777), opts);
+    auto a = chunkAll(whole);
+    auto b = chunkAll(trickle);
+
+    ASSERT_EQ(a.size(), b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].offset, b[i].offset);
+        EXPECT_EQ(a[i].fingerprint, b[i].fingerprint);
+    }
+}
+
+TEST(IOTest, ChunkingReaderResyncsAfterInsertion) {
+    std::string data = randomData(1 << 20, 3);
+    std::string edited = data;
+    edited.insert(300 * 1024, "inserted bytes");
+
+    ChunkerOptions opts;
+    opts.fingerprint = true;
+    ChunkingReader before(std::make_shared<StringReader>(data), opts);
+    ChunkingReader after(std::make_shared<StringReader>(edited), opts);
+    auto a = chunkAll(before);
+    auto b = chunkAll(after);
+
+    std::set<uint64_t> seen;
+    for (const auto& c : a) seen.insert(c.fingerprint);
+    std::size_t shared = 0;
+    for (const auto& c : b) shared += seen.count(c.fingerprint);
+
+    EXPECT_GE(shared + 3, a.size());   // only chunks around the edit change
+}
+
+TEST(IOTest, ChunkingReaderReadCopiesStream) {
+    std::string data = randomData(200 * 1024, 5);
+    auto cr = std::make_shared<ChunkingReader>(std::make_shared<StringReader>(data));
+    auto writer = std::make_shared<VectorWriter>();
+
+    auto res = Copy(writer, cr);
+    EXPECT_TRUE(res.Ok());
+    EXPECT_EQ(writer->str(), data);
+}
+
+TEST(IOTest, FingerprintMatchesXXH64) {
+    EXPECT_EQ(Fingerprint(nullptr, 0), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(Fingerprint(reinterpret_cast<const uint8_t*>("abc"), 3), 0x44BC2CF5AD770999ULL);
+}
+
+TEST(IOTest, MessagePipeReclaimsLanesOfDestroyedWriters) {
+    auto [r, w] = MessagePipe();
+    std::vector<std::vector<uint8_t>> batch;
+
+    for (int i = 0; i < 10000; ++i) {
+        {
+            auto task = w->newWriter();
+            WriteString(task, "task");
+        }
+        if (i % 100 == 99) {
+            batch.clear();
+            auto res = r->readBatch(batch, 1000);
+            ASSERT_TRUE(res.Ok());
+            EXPECT_EQ(res.value, 100u);
+            EXPECT_LE(r->lanes(), 2u);
+        }
+    }
+
+    EXPECT_EQ(r->lanes(), 1u);   // only `w` is left
+}
+
+TEST(IOTest, CopySparseWritesZerosToUnseekableFile) {
+    int fds[2];
+#ifdef _WIN32
+    ASSERT_EQ(_pipe(fds, 65536, _O_BINARY), 0);
+#else
+    ASSERT_EQ(pipe(fds), 0);
+#endif
+    auto readEnd = std::make_shared<File>(fds[0], "pipe");
+    auto writeEnd = std::make_shared<File>(fds[1], "pipe");
+
+    std::string data = "x";
+    data.append(8192, '\0');
+    data.append("y");
+
+    auto res = CopySparse(writeEnd, std::make_shared<StringReader>(data));
+    EXPECT_TRUE(res.Ok());
+    EXPECT_EQ(res.value, data.size());
+    writeEnd->close();
+
+    std::vector<uint8_t> out;
+    ReadAll(readEnd, out);
+    EXPECT_EQ(std::string(out.begin(), out.end()), data);
+}
+
+TEST(IOTest, CopySparseClearsOldDataInDestination) {
+    TempPath dstPath("gocxx_io_sparse_overwrite");
+    constexpr std::size_t size = 64 * 1024;
+
+    auto dst = File::Create(dstPath.str());
+    ASSERT_TRUE(dst.Ok());
+    std::vector<uint8_t> old(size, 0xAA);
+    ASSERT_TRUE(dst.value->write(old.data(), old.size()).Ok());
+    dst.value->seek(0, SeekStart);
+
+    std::string data("start");
+    data.append(size - 10, '\0');
+    data.append("end!!");
+
+    auto res = CopySparse(dst.value, std::make_shared<StringReader>(data));
+    EXPECT_TRUE(res.Ok());
+    EXPECT_EQ(res.value, data.size());
+
+    std::vector<uint8_t> got(size);
+    EXPECT_TRUE(dst.value->readAt(got.data(), got.size(), 0).Ok());
+    EXPECT_EQ(std::string(got.begin(), got.end()), data);
+}
+
+TEST(IOTest, CopySparseWritesZerosWhenPunchFails) {
+    // Seekable in-memory target that cannot punch holes.
+    class MemoryFile : public Writer, public Seeker, public HolePuncher {
+    public:
+        std::vector<uint8_t> data;
+        std::size_t pos = 0;
+
+        Result<std::size_t> write(const uint8_t* buf, std::size_t size) override {
+            if (pos + size > data.size()) data.resize(pos + size, 0);
+            std::copy(buf, buf + size, data.begin() + pos);
+            pos += size;
+            return size;
+        }
+
+        Result<std::size_t> seek(std::size_t offset, whence whence) override {
+            if (whence == SeekStart) pos = offset;
+            else if (whence == SeekCurrent) pos += offset;
+            else if (whence == SeekEnd) pos = data.size() + offset;
+            else return { 0, ErrUnsupported };
+            return pos;
+        }
+
+        Result<std::size_t> punchHole(std::size_t, std::size_t) override {
+            return { 0, ErrUnsupported };
+        }
+    };
+
+    auto dst = std::make_shared<MemoryFile>();
+    dst->data.assign(10000, 0xAA);
+
+    std::string data("a");
+    data.append(20000, '\0');
+    data.append("z");
+
+    auto res = CopySparse(dst, std::make_shared<StringReader>(data));
+    EXPECT_TRUE(res.Ok());
+    EXPECT_EQ(std::string(dst->data.begin(), dst->data.end()), data);
+}
+
+TEST(IOTest, ChunkingReaderNextResumesPartialRead) {
+    std::string data = randomData(256 * 1024, 13);
+    ChunkerOptions opts;
+    opts.fingerprint = true;
+    ChunkingReader cr(std::make_shared<StringReader>(data), opts);
+
+    std::vector<uint8_t> head(10);
+    auto rres = cr.read(head.data(), head.size());
+    ASSERT_TRUE(rres.Ok());
+    EXPECT_EQ(rres.value, 10u);
+
+    auto rest = cr.next();
+    ASSERT_TRUE(rest.Ok());
+    EXPECT_EQ(rest.value.offset, 10u);
+    EXPECT_EQ(rest.value.fingerprint, Fingerprint(rest.value.data, rest.value.size));
+
+    std::string joined(head.begin(), head.end());
+    joined.append(reinterpret_cast<const char*>(rest.value.data), rest.value.size);
+    chunkAll(cr, &joined);
+    EXPECT_EQ(joined, data);
+}